@@ -0,0 +1,174 @@
+// Controle adaptativo de timeout e cadencia de requisicoes Modbus por dispositivo
+// Compartilhado entre Main_Project e Real_Demo_Project
+#ifndef MODBUS_TIMING_H
+#define MODBUS_TIMING_H
+
+#include <modbus/modbus.h>
+#include <cerrno>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <ostream>
+
+// Constantes do controle adaptativo de timeout e cadencia (valores em ms)
+#define RTO_INITIAL_MS 1000          // Timeout inicial, antes da primeira medicao de RTT
+#define RTO_MIN_MS 100               // Timeout minimo padrao (ajustavel por dispositivo)
+#define RTO_MAX_MS 4000              // Timeout maximo (enlaces lentos, ex. modem celular)
+#define RTT_GRANULARITY_MS 10        // Granularidade minima somada ao RTT suavizado
+#define PACING_MIN_INTERVAL_MS 20    // Intervalo minimo padrao entre requisicoes ao mesmo dispositivo
+#define PACING_RTT_FACTOR 1.0        // Pausa apos cada resposta, em multiplos do RTT suavizado
+#define RATE_WINDOW_MS 10000         // Janela para calculo da taxa de requisicoes alcancada
+
+// Estrutura com o controle adaptativo de timeout e cadencia de um dispositivo
+// Estima RTT medio e variancia no estilo do RTO do TCP (RFC 6298)
+struct DeviceTiming {
+    int rto_min_ms = RTO_MIN_MS; // Timeout minimo deste dispositivo
+    int min_request_gap_ms = PACING_MIN_INTERVAL_MS; // Intervalo minimo entre requisicoes
+    double srtt_ms = 0;          // RTT suavizado
+    double rttvar_ms = 0;        // Variacao do RTT
+    double rto_ms = RTO_INITIAL_MS; // Timeout atual de resposta
+    bool has_rtt_sample = false; // Indica se ja houve alguma medicao de RTT
+    int consecutive_timeouts = 0; // Requisicoes seguidas sem resposta
+    double achieved_rate_hz = 0; // Taxa de requisicoes alcancada na ultima janela
+    unsigned long request_count = 0; // Total de requisicoes enviadas (inclui retentativas)
+    unsigned long timeout_count = 0; // Total de requisicoes sem resposta no prazo
+    unsigned long retry_count = 0;   // Total de retentativas apos timeout
+    unsigned long connect_timeout_count = 0; // Total de timeouts na conexao TCP
+    unsigned long window_requests = 0; // Requisicoes na janela atual de taxa
+    std::chrono::steady_clock::time_point window_start;       // Inicio da janela de taxa
+    std::chrono::steady_clock::time_point next_request_time;  // Proximo instante permitido
+    std::chrono::steady_clock::time_point next_cycle_time;    // Inicio do proximo ciclo de leitura
+};
+
+// Atualiza estimativa de RTT e recalcula o timeout apos uma resposta valida
+inline void RegisterRttSample(DeviceTiming& timing, double rtt_ms) {
+    if (!timing.has_rtt_sample) {
+        timing.srtt_ms = rtt_ms;
+        timing.rttvar_ms = rtt_ms / 2;
+        timing.has_rtt_sample = true;
+    } else {
+        timing.rttvar_ms = 0.75 * timing.rttvar_ms + 0.25 * std::fabs(timing.srtt_ms - rtt_ms);
+        timing.srtt_ms = 0.875 * timing.srtt_ms + 0.125 * rtt_ms;
+    }
+
+    double rto = timing.srtt_ms + std::max(static_cast<double>(RTT_GRANULARITY_MS), 4 * timing.rttvar_ms);
+    timing.rto_ms = std::min(std::max(rto, static_cast<double>(timing.rto_min_ms)), static_cast<double>(RTO_MAX_MS));
+}
+
+// Registra uma requisicao sem resposta no prazo
+// O RTO so dobra no primeiro timeout de uma sequencia: um dispositivo fora do ar
+// continua sendo consultado com o mesmo timeout, sem crescer a cada ciclo
+inline void RegisterTimeout(DeviceTiming& timing) {
+    timing.timeout_count++;
+    if (timing.consecutive_timeouts++ == 0) {
+        timing.rto_ms = std::min(timing.rto_ms * 2, static_cast<double>(RTO_MAX_MS));
+    }
+}
+
+// Registra timeout no estabelecimento da conexao TCP (nao altera o RTO de resposta)
+inline void RegisterConnectTimeout(DeviceTiming& timing) {
+    timing.connect_timeout_count++;
+}
+
+// Aplica o timeout atual ao contexto Modbus
+// O timeout entre bytes e metade do RTO, sem ficar abaixo do minimo do dispositivo
+inline void ApplyModbusTimeouts(modbus_t* ctx, const DeviceTiming& timing) {
+    uint32_t rto_us = static_cast<uint32_t>(timing.rto_ms * 1000);
+    uint32_t byte_us = std::max(rto_us / 2, static_cast<uint32_t>(timing.rto_min_ms) * 1000);
+    modbus_set_response_timeout(ctx, rto_us / 1000000, rto_us % 1000000);
+    modbus_set_byte_timeout(ctx, byte_us / 1000000, byte_us % 1000000);
+}
+
+// Aguarda o inicio do proximo ciclo de leitura (cadencia fixa contada do inicio do ciclo)
+inline void WaitForPollCycle(DeviceTiming& timing, int period_ms) {
+    std::this_thread::sleep_until(timing.next_cycle_time);
+    timing.next_cycle_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(period_ms);
+}
+
+// Aguarda o proximo instante permitido para enviar requisicao ao dispositivo
+// e contabiliza a requisicao na taxa alcancada
+inline void WaitForRequestSlot(DeviceTiming& timing) {
+    std::this_thread::sleep_until(timing.next_request_time);
+
+    auto now = std::chrono::steady_clock::now();
+    if (timing.request_count == 0) {
+        timing.window_start = now;
+    }
+
+    // Taxa alcancada = requisicoes na janela / duracao da janela
+    double window_ms = std::chrono::duration<double, std::milli>(now - timing.window_start).count();
+    if (window_ms >= RATE_WINDOW_MS) {
+        timing.achieved_rate_hz = 1000.0 * timing.window_requests / window_ms;
+        timing.window_start = now;
+        timing.window_requests = 0;
+    }
+
+    timing.next_request_time = now + std::chrono::milliseconds(timing.min_request_gap_ms);
+    timing.request_count++;
+    timing.window_requests++;
+}
+
+// Reserva uma pausa proporcional ao RTT, contada do fim da resposta (o cliente e sincrono)
+inline void ReserveIdleAfterResponse(DeviceTiming& timing) {
+    auto idle_until = std::chrono::steady_clock::now()
+                    + std::chrono::microseconds(static_cast<long>(PACING_RTT_FACTOR * timing.srtt_ms * 1000));
+    timing.next_request_time = std::max(timing.next_request_time, idle_until);
+}
+
+// Executa uma requisicao Modbus com cadencia e timeout adaptativos, medindo o RTT
+// Apos um timeout, repete uma vez com o RTO dobrado, exceto se a requisicao anterior
+// tambem expirou ou se o RTO ja esta no maximo (dispositivo provavelmente fora do ar)
+template <typename Request>
+int TimedModbusRequest(modbus_t* ctx, DeviceTiming& timing, Request request) {
+    WaitForRequestSlot(timing);
+    ApplyModbusTimeouts(ctx, timing);
+
+    auto start = std::chrono::steady_clock::now();
+    int rc = request();
+    int saved_errno = errno;
+
+    if (rc != -1) {
+        RegisterRttSample(timing, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        timing.consecutive_timeouts = 0;
+    } else if (saved_errno == ETIMEDOUT) {
+        bool can_retry = (timing.consecutive_timeouts == 0) && (timing.rto_ms < RTO_MAX_MS);
+        RegisterTimeout(timing);
+
+        if (can_retry) {
+            timing.retry_count++;
+
+            // Descarta resposta atrasada e repete com o timeout dobrado
+            // O RTT da retentativa nao e amostrado (algoritmo de Karn)
+            modbus_flush(ctx);
+            WaitForRequestSlot(timing);
+            ApplyModbusTimeouts(ctx, timing);
+            rc = request();
+            saved_errno = errno;
+
+            if (rc != -1) {
+                timing.consecutive_timeouts = 0;
+            } else if (saved_errno == ETIMEDOUT) {
+                RegisterTimeout(timing);
+            }
+        }
+    }
+
+    ReserveIdleAfterResponse(timing);
+
+    errno = saved_errno;
+    return rc;
+}
+
+// Escreve estatisticas de temporizacao do dispositivo
+inline void WriteDeviceTiming(std::ostream& out, const DeviceTiming& timing) {
+    out << "srtt=" << timing.srtt_ms << "ms"
+        << " rttvar=" << timing.rttvar_ms << "ms"
+        << " rto=" << timing.rto_ms << "ms"
+        << " taxa=" << timing.achieved_rate_hz << "Hz"
+        << " timeouts=" << timing.timeout_count << "/" << timing.request_count
+        << " retentativas=" << timing.retry_count
+        << " timeouts_conexao=" << timing.connect_timeout_count;
+}
+
+#endif // MODBUS_TIMING_H
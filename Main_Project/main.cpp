@@ -14,10 +14,18 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <errno.h>
+
+#include "modbus_timing.h"
 
 using namespace std;
 using namespace opendnp3;
 
+// Constantes da cadencia de leitura (controle de timeout em modbus_timing.h)
+#define POLL_INTERVAL_MS 1000        // Intervalo nominal entre ciclos de leitura
+#define ESP8266_RTO_MIN_MS 400       // Timeout minimo do ESP8266 (absorve picos de jitter do WiFi)
+#define TIMING_LOG_EVERY 10          // Registra estatisticas a cada N ciclos de leitura
+
 // Estrutura para armazenar o estado da aplicacao
 struct State {
     int16_t analog = 0;                     // Valor analogico de entrada
@@ -33,6 +41,7 @@ struct State {
     bool last_connection_state = false;      // Estado anterior da conexao
     int failure_count = 0;                   // Contador de falhas consecutivas
     const int max_failures_before_zero = 5;  // Maximo de falhas antes de enviar zero
+    DeviceTiming timing;                     // Controle adaptativo de timeout/cadencia
 };
 
 // Configura os pontos da base de dados DNP3
@@ -85,6 +94,13 @@ void AddUpdates(UpdateBuilder& builder, State& state) {
     builder.Update(Binary(state.button_status), 2);
 }
 
+// Registra estatisticas de temporizacao do dispositivo
+void LogDeviceTiming(const DeviceTiming& timing) {
+    cout << "Modbus timing: ";
+    WriteDeviceTiming(cout, timing);
+    cout << endl;
+}
+
 // Tenta reconectar ao dispositivo Modbus
 bool TryModbusReconnect(modbus_t* ctx, const char* ip, int port, int slave_id, State& state) {
     cout << "Tentando reconectar ao Modbus..." << endl;
@@ -102,10 +118,11 @@ bool TryModbusReconnect(modbus_t* ctx, const char* ip, int port, int slave_id, S
             cerr << "Falha ao criar novo contexto Modbus" << endl;
             return false;
         }
-        modbus_set_response_timeout(ctx, 1, 0);
-        modbus_set_byte_timeout(ctx, 1, 0);
     }
 
+    // Usa o timeout adaptativo atual do dispositivo
+    ApplyModbusTimeouts(ctx, state.timing);
+
     // Configura ID do escravo
     if (modbus_set_slave(ctx, slave_id) == -1) {
         cerr << "Erro ao configurar ID do escravo: " << modbus_strerror(errno) << endl;
@@ -115,6 +132,9 @@ bool TryModbusReconnect(modbus_t* ctx, const char* ip, int port, int slave_id, S
 
     // Tenta conexao
     if (modbus_connect(ctx) == -1) {
+        if (errno == ETIMEDOUT) {
+            RegisterConnectTimeout(state.timing);
+        }
         cerr << "Falha na reconexao: " << modbus_strerror(errno) << endl;
         return false;
     }
@@ -139,7 +159,9 @@ bool ReadModbusValues(modbus_t* ctx, const char* ip, int port, int slave_id, Sta
 
     // Le registro analogico
     modbus_flush(ctx);
-    int rc = modbus_read_registers(ctx, 0, 1, tab_reg);
+    int rc = TimedModbusRequest(ctx, state.timing, [&]() {
+        return modbus_read_registers(ctx, 0, 1, tab_reg);
+    });
     
     if (rc == -1) {
         cerr << "Erro na leitura do potenciometro: " << modbus_strerror(errno) << endl;
@@ -150,7 +172,9 @@ bool ReadModbusValues(modbus_t* ctx, const char* ip, int port, int slave_id, Sta
     }
 
     // Le status do LED
-    rc = modbus_read_bits(ctx, state.COIL_STATUS_LED, 1, &led_status);
+    rc = TimedModbusRequest(ctx, state.timing, [&]() {
+        return modbus_read_bits(ctx, state.COIL_STATUS_LED, 1, &led_status);
+    });
     
     if (rc == -1) {
         cerr << "Erro na leitura do status do LED: " << modbus_strerror(errno) << endl;
@@ -161,7 +185,9 @@ bool ReadModbusValues(modbus_t* ctx, const char* ip, int port, int slave_id, Sta
     }
 
     // Le status do botao
-    rc = modbus_read_bits(ctx, state.COIL_STATUS_BUTTON, 1, &button_status);
+    rc = TimedModbusRequest(ctx, state.timing, [&]() {
+        return modbus_read_bits(ctx, state.COIL_STATUS_BUTTON, 1, &button_status);
+    });
     
     if (rc == -1) {
         cerr << "Erro na leitura do coil do Botao: " << modbus_strerror(errno) << endl;
@@ -289,6 +315,7 @@ int main() {
     
     // Inicializa estado da aplicacao
     State state;
+    state.timing.rto_min_ms = ESP8266_RTO_MIN_MS;
 
     // Configura niveis de log DNP3
     const auto logLevels = levels::NORMAL | levels::NOTHING;
@@ -332,7 +359,11 @@ int main() {
     outstation->Enable();
 
     // Loop principal da aplicacao
+    unsigned long cycle_count = 0;
     while (!shutdown_flag) {
+        // Aguarda o proximo ciclo (cadencia fixa contada do inicio do ciclo anterior)
+        WaitForPollCycle(state.timing, POLL_INTERVAL_MS);
+
         // Le valores do Modbus
         bool read_success = ReadModbusValues(ctx, modbus_ip, modbus_port, modbus_slave_id, state);
 
@@ -354,7 +385,10 @@ int main() {
                  << " (Status: CONECTADO)" << endl;
         }
 
-        this_thread::sleep_for(chrono::seconds(1));
+        // Log periodico das estatisticas de temporizacao
+        if (++cycle_count % TIMING_LOG_EVERY == 0) {
+            LogDeviceTiming(state.timing);
+        }
     }
 
     // Limpeza da conexao Modbus
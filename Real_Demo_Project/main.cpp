@@ -23,6 +23,9 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <algorithm>
+
+#include "modbus_timing.h"
 
 using namespace std;
 using namespace opendnp3;
@@ -32,6 +35,10 @@ using namespace opendnp3;
 #define NUM_HOLDING_REGISTERS 2  // Numero de registros holding para leitura (32 bits)
 #define NUM_INPUT_REGISTERS 1    // Numero de registros input para leitura (16 bits)
 
+// Constantes da cadencia de leitura (controle de timeout em modbus_timing.h)
+#define POLL_INTERVAL_MS 1000        // Intervalo nominal entre leituras de cada slave
+#define TIMING_LOG_EVERY 10          // Registra estatisticas a cada N ciclos de leitura
+
 // Mutexes para sincronizacao
 mutex data_mutex;                // Protege dados compartilhados entre threads
 mutex dnp3_update_mutex;         // Protege atualizacoes DNP3
@@ -45,6 +52,7 @@ struct SlaveState {
     int failure_count = 0;       // Contador de falhas consecutivas
     const int max_failures_before_zero = 5; // Max falhas antes de zerar valor
     chrono::system_clock::time_point last_change_time; // Timestamp da ultima mudanca
+    DeviceTiming timing;         // Controle de timeout/cadencia (acessado so pela thread do slave)
 };
 
 // Funcao para configurar banco de dados DNP3
@@ -77,6 +85,7 @@ typedef struct {
     int is_first_slave;         // Flag para primeiro slave (tipo de registro diferente)
     int dnp3_analog_index;      // Indice DNP3 para valor analogico
     int dnp3_status_index;      // Indice DNP3 para status
+    int rto_min_ms;             // Timeout minimo de resposta (ms), conforme o enlace do slave
 } SlaveConfig;
 
 // Atualiza valores DNP3 baseado no estado do slave
@@ -122,6 +131,13 @@ void HandleCommunicationSuccess(SlaveState& state) {
     }
 }
 
+// Registra estatisticas de temporizacao do slave
+void LogDeviceTiming(int slave_index, const DeviceTiming& timing) {
+    cout << "Slave " << slave_index << " timing: ";
+    WriteDeviceTiming(cout, timing);
+    cout << endl;
+}
+
 // Converte registros Modbus para inteiro 32 bits
 int32_t modbusRegistersToInt32(uint16_t* regs, bool is_signed) {
     int32_t value = (regs[0] << 16) | regs[1];
@@ -140,21 +156,34 @@ void PollSlave(int slave_index, SlaveConfig* slaves, vector<SlaveState>* slave_s
     // Atraso inicial escalonado para evitar congestionamento
     this_thread::sleep_for(chrono::milliseconds(100 * slave_index));
 
+    // Controle de timeout/cadencia, usado somente por esta thread
+    DeviceTiming& timing = (*slave_states)[slave_index].timing;
+    timing.rto_min_ms = slaves[slave_index].rto_min_ms;
+    unsigned long cycle_count = 0;
+
     while (true) {
         bool read_success = false;
+
+        // Aguarda o proximo ciclo (cadencia fixa contada do inicio do ciclo anterior)
+        WaitForPollCycle(timing, POLL_INTERVAL_MS);
         
         // Cria novo contexto Modbus para cada tentativa
         modbus_t* ctx = modbus_new_tcp(slaves[slave_index].ip, slaves[slave_index].port);
         if (ctx) {
             modbus_set_slave(ctx, slaves[slave_index].slave_id);
-            modbus_set_response_timeout(ctx, 1, 0);
-            modbus_set_byte_timeout(ctx, 0, 500000);
+            ApplyModbusTimeouts(ctx, timing);
 
-            if (modbus_connect(ctx) != -1) {
+            if (modbus_connect(ctx) == -1) {
+                if (errno == ETIMEDOUT) {
+                    RegisterConnectTimeout(timing);
+                }
+            } else {
                 try {
                     // Primeiro slave usa holding registers, outros usam input registers
                     if (slaves[slave_index].is_first_slave) {
-                        int rc = modbus_read_registers(ctx, HOLDING_REG_OFFSET, NUM_HOLDING_REGISTERS, tab_reg);
+                        int rc = TimedModbusRequest(ctx, timing, [&]() {
+                            return modbus_read_registers(ctx, HOLDING_REG_OFFSET, NUM_HOLDING_REGISTERS, tab_reg);
+                        });
                         if (rc != -1) {
                             lock_guard<mutex> lock(data_mutex);
                             (*slave_states)[slave_index].analog_value = modbusRegistersToInt32(tab_reg, true);
@@ -163,7 +192,9 @@ void PollSlave(int slave_index, SlaveConfig* slaves, vector<SlaveState>* slave_s
                             read_success = true;
                         }
                     } else {
-                        int rc = modbus_read_input_registers(ctx, INPUT_REG_OFFSET, NUM_INPUT_REGISTERS, tab_reg);
+                        int rc = TimedModbusRequest(ctx, timing, [&]() {
+                            return modbus_read_input_registers(ctx, INPUT_REG_OFFSET, NUM_INPUT_REGISTERS, tab_reg);
+                        });
                         if (rc != -1) {
                             lock_guard<mutex> lock(data_mutex);
                             (*slave_states)[slave_index].analog_value = static_cast<int16_t>(tab_reg[0]);
@@ -208,7 +239,10 @@ void PollSlave(int slave_index, SlaveConfig* slaves, vector<SlaveState>* slave_s
             outstation->Apply(builder.Build());
         }
 
-        this_thread::sleep_for(chrono::seconds(1));
+        if (++cycle_count % TIMING_LOG_EVERY == 0) {
+            lock_guard<mutex> lock(data_mutex);
+            LogDeviceTiming(slave_index, timing);
+        }
     }
 }
 
@@ -243,13 +277,14 @@ int main() {
     * 4. Tipo de registro (1 = holding registers, 0 = input registers)
     * 5. Indice do ponto analogico no DNP3
     * 6. Indice do ponto binario (status) no DNP3
+    * 7. Timeout minimo de resposta em ms (baixo para medidores em LAN)
     *
     * O primeiro slave usa holding registers (32 bits) enquanto os demais usam input registers (16 bits)
     */
     SlaveConfig slaves[NUM_SLAVES] = {
-        {"10.1.1.116", 502, 1, 1, 0, 0},
-        {"10.1.1.41", 502, 1, 0, 1, 1},
-        {"10.1.1.42", 502, 1, 0, 2, 2}
+        {"10.1.1.116", 502, 1, 1, 0, 0, RTO_MIN_MS},
+        {"10.1.1.41", 502, 1, 0, 1, 1, RTO_MIN_MS},
+        {"10.1.1.42", 502, 1, 0, 2, 2, RTO_MIN_MS}
     };
 
     vector<SlaveState> slave_states(NUM_SLAVES);